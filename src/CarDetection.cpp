@@ -6,34 +6,40 @@ using namespace cv;
 /**
 	Constructor of the class.
 
-	@param image = image useful to print the final result.
-	@param segmented = image in which is defined the ROI where detect the car.
+	@param context = context of the frame, in which is defined the ROI where detect the car
+	                 and the image useful to print the final result.
 	@param min_y = upper limit of the road detected
 	@param max_y = lower limit of the road detected
 */
-CarDetection::CarDetection(Mat image, Mat segmented, int min_y, int max_y){
-	this -> image = image;
-	this -> segmented = segmented;
+CarDetection::CarDetection(FrameContext& context, int min_y, int max_y) : context(context){
+	this -> image = context.getOverlay();
 	this -> min_y = min_y;
 	this -> max_y = max_y;
 }
 
 /**
 	Method that blurs the image and using Canny detects the edges.
+	If the road has not been set in the context there is no ROI, so no edge is found.
 */
 void CarDetection::segmentation(){
 
-	// Convert the image with the ROI to gray.
-	Mat gray;
-	cvtColor(this -> segmented, gray, CV_BGR2GRAY);
+	// Gray image with the ROI: only the pixels of the road spans are kept.
+	Mat frameGray = this -> context.getGray();
+	const vector<Vec2i>& spans = this -> context.getRoadSpans();
+
+	Mat gray = Mat::zeros(frameGray.size(), CV_8UC1);
+	for (int y = 0; y < gray.rows && y < (int)spans.size(); ++y){
+		if (spans[y][1] > spans[y][0]){
+			frameGray.row(y).colRange(spans[y][0], spans[y][1]).copyTo(gray.row(y).colRange(spans[y][0], spans[y][1]));
+		}
+	}
 
 	blur(gray, gray, Size(5,5));
 
 	Mat detected_edges;
 	Canny(gray, detected_edges, 30, 90);
 
-	this -> cannyResult = Scalar::all(0);
-    this -> image.copyTo( this -> cannyResult, detected_edges); //Save the result
+	this -> cannyResult = detected_edges; //Save the result
 
 }
 
@@ -44,12 +50,12 @@ void CarDetection::summedAreaTable(Mat input){
 
 	this -> sat = Mat(this -> cannyResult.size(), CV_64F);
 	
-	int pixel_value = 0; //Zero if the pixel is balck, one otherwise.
+	int pixel_value = 0; //Zero if the pixel is not an edge, one otherwise.
 	
 	for (int x = 0; x < this -> cannyResult.cols; ++x){
 		for (int y = 0; y < this -> cannyResult.rows; ++y){
 			
-			if (this -> cannyResult.at<Vec3b>(Point(x,y)) == black){
+			if (this -> cannyResult.at<uchar>(Point(x,y)) == 0){
 				pixel_value = 0;
 			}
 			else{
@@ -81,6 +87,8 @@ void CarDetection::summedAreaTable(Mat input){
 */
 void CarDetection::findOptDensity(Mat summedAreaTable){
 	this -> message = 0; //None obstacle.
+	this -> window = Rect();
+	this -> density = 0;
 
 	Point topLeft_corner;
 	topLeft_corner.x = 0;
@@ -104,10 +112,7 @@ void CarDetection::findOptDensity(Mat summedAreaTable){
 		for (int x = topLeft_corner.x; x + window_size < x_limit; ++x){
 			for (int y = topLeft_corner.y; y + window_size < y_limit; ++y){
 				
-				//Number pixel edges in the area.
-				int whitePixels = summedAreaTable.at<float>(Point(x,y)) + summedAreaTable.at<float>(Point(x+window_size,y+window_size))
-					- summedAreaTable.at<float>(Point(x+window_size,y)) - summedAreaTable.at<float>(Point(x,y+window_size));
-				float density = whitePixels / (float)(window_size*window_size);
+				float density = windowDensity(summedAreaTable, Point(x,y), window_size);
 
 				if (density > maxDensity){
 					corner_prov.x = x;
@@ -125,12 +130,13 @@ void CarDetection::findOptDensity(Mat summedAreaTable){
 		
 		
 		if (maxDensity > 0.065){
-			line(image, topLeft_corner, Point(topLeft_corner.x + window_size, topLeft_corner.y), Scalar(0,0,255), 15, 8);
-			line(image, topLeft_corner, Point(topLeft_corner.x, topLeft_corner.y + window_size), Scalar(0,0,255), 15, 8);
-			line(image, Point(topLeft_corner.x + window_size, topLeft_corner.y + window_size), Point(topLeft_corner.x, topLeft_corner.y + window_size), Scalar(0,0,255), 15, 8);
-			line(image, Point(topLeft_corner.x + window_size, topLeft_corner.y), Point(topLeft_corner.x + window_size, topLeft_corner.y + window_size), Scalar(0,0,255), 15, 8);
+			drawWindow(topLeft_corner, window_size);
 			stop = true;
 
+			// The density saved is the one of the window drawn, not of the larger window searched.
+			this -> window = Rect(topLeft_corner.x, topLeft_corner.y, window_size, window_size);
+			this -> density = windowDensity(summedAreaTable, topLeft_corner, window_size);
+
 			getPriority(topLeft_corner, window_size);
 		}
 		
@@ -141,6 +147,36 @@ void CarDetection::findOptDensity(Mat summedAreaTable){
 
 }
 
+/**
+	Method that computes the edge density of a window using the summed area table.
+
+	@param summedAreaTable = input summed area table.
+	@param topleft = coordinates of the top left corner of the window.
+	@param window_size = size of the window
+	@return float = number of edge pixels in the window divided by its area.
+*/
+float CarDetection::windowDensity(Mat summedAreaTable, Point topleft, int window_size){
+
+	//Number pixel edges in the area.
+	int whitePixels = summedAreaTable.at<float>(topleft) + summedAreaTable.at<float>(Point(topleft.x+window_size,topleft.y+window_size))
+		- summedAreaTable.at<float>(Point(topleft.x+window_size,topleft.y)) - summedAreaTable.at<float>(Point(topleft.x,topleft.y+window_size));
+
+	return whitePixels / (float)(window_size*window_size);
+}
+
+/**
+	Method that draws the window of the car detected.
+
+	@param topleft = coordinates of the top left corner of the window.
+	@param window_size = size of the window
+*/
+void CarDetection::drawWindow(Point topleft, int window_size){
+	line(image, topleft, Point(topleft.x + window_size, topleft.y), Scalar(0,0,255), 15, 8);
+	line(image, topleft, Point(topleft.x, topleft.y + window_size), Scalar(0,0,255), 15, 8);
+	line(image, Point(topleft.x + window_size, topleft.y + window_size), Point(topleft.x, topleft.y + window_size), Scalar(0,0,255), 15, 8);
+	line(image, Point(topleft.x + window_size, topleft.y), Point(topleft.x + window_size, topleft.y + window_size), Scalar(0,0,255), 15, 8);
+}
+
 /**
 	Method that computes if the car in front is too close.
 
@@ -177,6 +213,23 @@ void CarDetection::detectCar(){
 	CarDetection::findOptDensity(sat);
 }
 
+/**
+	Public method that draws on the image a car found in a previous frame, without
+	searching it again.
+
+	@param window = window of the car, empty if there is no car.
+	@param message = level of alert of the car.
+*/
+void CarDetection::drawCar(Rect window, int message){
+
+	this -> window = window;
+	this -> message = message;
+
+	if (window.width > 0){
+		drawWindow(window.tl(), window.width);
+	}
+}
+
 /**
     @return Mat = image with the detected car.
 */
@@ -190,3 +243,17 @@ Mat CarDetection::getDetectedCar(){
 int CarDetection::getMessage(){
 	return message;
 }
+
+/**
+    @return Rect = window of the detected car, empty if there is no car.
+*/
+Rect CarDetection::getWindow(){
+	return window;
+}
+
+/**
+    @return float = edge density of the window of the detected car.
+*/
+float CarDetection::getDensity(){
+	return density;
+}
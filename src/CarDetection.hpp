@@ -5,33 +5,41 @@
 #include <opencv2/core.hpp>
 #include <chrono>
 
+#include "FrameContext.hpp"
+
 class CarDetection
 {
 	private:
+    	FrameContext& context;
+
     	cv::Mat image;
-    	cv::Mat segmented;
     	cv::Mat cannyResult;
     	cv::Mat sat;
 
     	int min_y;
     	int max_y;
 
-    	cv::Vec3b black = cv::Vec3b(0,0,0);
-
     	int const min_window_size = 200;
 
     	int message;
+    	cv::Rect window; //window of the car detected, empty if there is no car
+    	float density; //edge density of the window, computed on the window itself
     
     public: 
-    	CarDetection(cv::Mat original, cv::Mat regionImage, int min, int max);
+    	CarDetection(FrameContext& context, int min, int max);
     	void detectCar();
+    	void drawCar(cv::Rect, int);
     	cv::Mat getDetectedCar();
     	int getMessage();
+    	cv::Rect getWindow();
+    	float getDensity();
 
     private:
     	void segmentation();
     	void summedAreaTable(cv::Mat);
     	void findOptDensity(cv::Mat);
+    	float windowDensity(cv::Mat, cv::Point, int);
+    	void drawWindow(cv::Point, int);
     	int getPriority(cv::Point, int);
 
 };
\ No newline at end of file
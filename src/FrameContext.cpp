@@ -0,0 +1,173 @@
+#include "FrameContext.hpp"
+
+using namespace std;
+using namespace cv;
+
+/**
+    Constructor of the class. The context holds the data of a single frame that is shared
+    by LaneLines and CarDetection; every derived image is computed the first time it is 
+    requested and then reused.
+
+    @param image = frame to be processed.
+*/
+FrameContext::FrameContext(cv::Mat image){
+
+    this -> image = image;
+    this -> road_found = false;
+}
+
+/**
+    @return Mat = original frame.
+*/
+Mat FrameContext::getImage(){
+	return image;
+}
+
+/**
+    @return Mat = frame converted to gray color-space, computed at the first call.
+*/
+Mat FrameContext::getGray(){
+
+    if (this -> gray.empty()){
+        cvtColor(this -> image, this -> gray, CV_BGR2GRAY);
+    }
+
+	return gray;
+}
+
+/**
+    Method that saves the image on which the results of the frame are drawn.
+
+    @param overlay = image with the detected portion of road.
+*/
+void FrameContext::setOverlay(cv::Mat overlay){
+
+    this -> overlay = overlay;
+}
+
+/**
+    @return Mat = image on which the results are drawn. If it has not been set, it is a copy
+                  of the frame, so the frame shared by the detectors is never drawn on.
+*/
+Mat FrameContext::getOverlay(){
+
+    if (this -> overlay.empty()){
+        this -> overlay = this -> image.clone();
+    }
+
+	return overlay;
+}
+
+/**
+    Method that saves the lane lines found in the frame. The road span table is computed
+    again at the next request.
+
+    @param m1 = slope coefficient of the left line.
+    @param q1 = constant of the left line.
+    @param m2 = slope coefficient of the right line.
+    @param q2 = constant of the right line.
+    @param max_y = lower limit of the road detected.
+*/
+void FrameContext::setRoad(float m1, float q1, float m2, float q2, int max_y){
+
+    this -> m1 = m1;
+    this -> q1 = q1;
+    this -> m2 = m2;
+    this -> q2 = q2;
+    this -> max_y = max_y;
+    this -> road_found = true;
+
+    this -> roadSpans.clear();
+}
+
+/**
+    Method that finds the columns of row y that are below a line translated of region_offset
+    px. The pixels below a line always form an interval, so only its limits are searched: 
+    they are estimated from the line equation and then adjusted with the same test used
+    on each pixel, so the result is exactly the set of pixels that pass the test.
+
+    @param y = row of the image.
+    @param m = slope coefficient of the line.
+    @param q = constant of the line.
+    @return Vec2i = first column and column after the last one of the interval.
+*/
+cv::Vec2i FrameContext::lineSpan(int y, float m, float q){
+
+    int cols = this -> image.cols;
+
+    auto below = [&](int x){ return y > m * x + q - region_offset; };
+
+    if (!(m > 0) && !(m < 0)){ //horizontal line or line not found
+        if (below(0)){
+            return Vec2i(0, cols);
+        }
+        return Vec2i(0, 0);
+    }
+
+    //Estimated limit of the interval, clamped to the image
+    double limit = (y - (double)q + region_offset) / m;
+    if (limit != limit){ //line not found
+        return Vec2i(0, 0);
+    }
+    int x = (int) min(max(limit, 0.0), (double)cols);
+
+    if (m > 0){ //pixels below the line are on the left of the limit
+        while (x > 0 && !below(x - 1)) x--;
+        while (x < cols && below(x)) x++;
+        return Vec2i(0, x);
+    }
+
+    //pixels below the line are on the right of the limit
+    while (x < cols && !below(x)) x++;
+    while (x > 0 && below(x - 1)) x--;
+    return Vec2i(x, cols);
+}
+
+/**
+    Method that returns, for each row of the frame, the interval of columns that belong to
+    the portion of road in front of the car: the pixels below both the lane lines translated
+    of region_offset px, or all the pixels below max_y + 200. The table is computed at the
+    first call after the road has been set.
+
+    @return vector = for each row, first column and column after the last one of the road;
+                     empty if the road has not been set.
+*/
+const std::vector<cv::Vec2i>& FrameContext::getRoadSpans(){
+
+    if (this -> road_found && this -> roadSpans.empty()){
+
+        this -> roadSpans.resize(this -> image.rows);
+
+        for (int y = 0; y < this -> image.rows; y++) {
+            if (y > max_y + 200){
+                this -> roadSpans[y] = Vec2i(0, this -> image.cols);
+            }
+            else{
+                Vec2i left = FrameContext::lineSpan(y, m1, q1);
+                Vec2i right = FrameContext::lineSpan(y, m2, q2);
+                int start = max(left[0], right[0]);
+                int end = max(start, min(left[1], right[1]));
+                this -> roadSpans[y] = Vec2i(start, end);
+            }
+        }
+    }
+
+    return roadSpans;
+}
+
+/**
+    @return int = first row of the frame with pixels of the road in front of the car, the
+                  number of rows if there is none or the road has not been set.
+*/
+int FrameContext::getRoadTop(){
+
+    const vector<Vec2i>& spans = FrameContext::getRoadSpans();
+
+    for (int y = 0; y < (int)spans.size(); y++) {
+        if (spans[y][1] > spans[y][0]){
+            return y;
+        }
+    }
+
+    return this -> image.rows;
+}
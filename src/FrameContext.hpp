@@ -0,0 +1,43 @@
+#ifndef FRAMECONTEXT_HPP
+#define FRAMECONTEXT_HPP
+
+#include <iostream>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/highgui.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/core.hpp>
+
+class FrameContext
+{
+	private:
+    	cv::Mat image;
+    	cv::Mat gray;
+    	cv::Mat overlay;
+
+    	std::vector<cv::Vec2i> roadSpans;
+
+    	bool road_found;
+    	float m1;
+    	float q1;
+    	float m2;
+    	float q2;
+    	int max_y;
+
+    	int const region_offset = 100; //translation of the lane lines for car detection
+
+	public:
+		FrameContext(cv::Mat);
+		cv::Mat getImage();
+		cv::Mat getGray();
+		void setOverlay(cv::Mat);
+		cv::Mat getOverlay();
+		void setRoad(float, float, float, float, int);
+		const std::vector<cv::Vec2i>& getRoadSpans();
+		int getRoadTop();
+
+	private:
+		cv::Vec2i lineSpan(int, float, float);
+
+};
+
+#endif
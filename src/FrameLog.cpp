@@ -0,0 +1,214 @@
+#include "FrameLog.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+    Constructor of the class. If the log already exists its header is checked: a file with
+    a different header is moved to <path>.invalid and a new log is started. A record written
+    only in part at the end of the file (e.g. after a crash) is removed, so that the new
+    records are appended at a record boundary. The records are written by a background thread.
+
+    @param path = path of the log file.
+*/
+FrameLog::FrameLog(std::string path){
+
+    this -> stop = false;
+    this -> length = 0;
+
+    this -> fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (this -> fd < 0){
+        cerr << "Unable to open the frame log " << path << ": " << strerror(errno) << endl;
+        return;
+    }
+
+    struct stat info;
+    if (fstat(this -> fd, &info) < 0){
+        cerr << "Unable to read the frame log " << path << ": " << strerror(errno) << endl;
+        close(this -> fd);
+        this -> fd = -1;
+        return;
+    }
+
+    off_t size = info.st_size;
+
+    if (size > 0 && !FrameLog::hasValidHeader()){
+        string rotated = path + ".invalid";
+        close(this -> fd);
+        this -> fd = -1;
+        if (rename(path.c_str(), rotated.c_str()) != 0){
+            cerr << "Invalid frame log " << path << ", unable to move it: " << strerror(errno) << endl;
+            return;
+        }
+        cerr << "Invalid frame log " << path << ", moved to " << rotated << endl;
+
+        this -> fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (this -> fd < 0){
+            cerr << "Unable to open the frame log " << path << ": " << strerror(errno) << endl;
+            return;
+        }
+        size = 0;
+    }
+
+    if (size == 0){
+        FrameLogHeader header;
+        copy(FRAME_LOG_MAGIC, FRAME_LOG_MAGIC + 8, header.magic);
+        header.version = FRAME_LOG_VERSION;
+        header.record_size = sizeof(FrameRecord);
+
+        if (!FrameLog::writeAll(&header, sizeof(header))){
+            cerr << "Unable to write the frame log " << path << ": " << strerror(errno) << endl;
+            close(this -> fd);
+            this -> fd = -1;
+            return;
+        }
+        this -> length = sizeof(header);
+    }
+    else{
+        //Keep only the complete records
+        this -> length = sizeof(FrameLogHeader) 
+            + (size - sizeof(FrameLogHeader)) / sizeof(FrameRecord) * sizeof(FrameRecord);
+
+        if (this -> length != size){
+            cerr << "Frame log " << path << " ends with a partial record, " << (size - this -> length) << " bytes removed" << endl;
+        }
+
+        if (ftruncate(this -> fd, this -> length) != 0 || lseek(this -> fd, this -> length, SEEK_SET) < 0){
+            cerr << "Unable to repair the frame log " << path << ": " << strerror(errno) << endl;
+            close(this -> fd);
+            this -> fd = -1;
+            return;
+        }
+    }
+
+    this -> writer = thread(&FrameLog::writeLoop, this);
+}
+
+/**
+    Destructor of the class. Waits until all the pending records are written.
+*/
+FrameLog::~FrameLog(){
+
+    if (this -> fd < 0){
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(this -> lock);
+        this -> stop = true;
+    }
+    this -> wakeUp.notify_one();
+
+    this -> writer.join();
+    close(this -> fd);
+}
+
+/**
+    Method that queues a record. It only copies the record, the file is written by the
+    background thread, so the caller is never blocked by the disk.
+
+    @param record = record of the current frame.
+*/
+void FrameLog::append(const FrameRecord& record){
+
+    if (this -> fd < 0){
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(this -> lock);
+        this -> pending.push_back(record);
+    }
+    this -> wakeUp.notify_one();
+}
+
+/**
+    Method that checks the header of an existing log: magic, version and record size must
+    be the ones of this program.
+
+    @return bool = true if the header is correct.
+*/
+bool FrameLog::hasValidHeader(){
+
+    FrameLogHeader header;
+    if (pread(this -> fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)){
+        return false;
+    }
+
+    return memcmp(header.magic, FRAME_LOG_MAGIC, 8) == 0 && header.version == FRAME_LOG_VERSION 
+        && header.record_size == sizeof(FrameRecord);
+}
+
+/**
+    Method that writes a buffer at the current position of the file, retrying after a
+    partial write or an interruption.
+
+    @param data = buffer to be written.
+    @param size = bytes of the buffer.
+    @return bool = true if all the bytes have been written.
+*/
+bool FrameLog::writeAll(const void* data, size_t size){
+
+    const char* bytes = (const char*) data;
+
+    while (size > 0){
+        ssize_t written = write(this -> fd, bytes, size);
+        if (written < 0){
+            if (errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+/**
+    Method executed by the background thread. It takes all the pending records at once
+    and writes them with a single call, until the log is closed. If a write fails, the
+    records of that batch are dropped and the file is cut back to the last complete record,
+    so the next batches stay aligned.
+*/
+void FrameLog::writeLoop(){
+
+    vector<FrameRecord> batch;
+
+    bool done = false;
+    while (!done){
+        {
+            unique_lock<mutex> guard(this -> lock);
+            this -> wakeUp.wait(guard, [this]{ return this -> stop || !this -> pending.empty(); });
+            batch.swap(this -> pending);
+            done = this -> stop;
+        }
+
+        if (batch.empty()){
+            continue;
+        }
+
+        size_t size = batch.size() * sizeof(FrameRecord);
+
+        if (FrameLog::writeAll(batch.data(), size)){
+            this -> length += size;
+        }
+        else{
+            cerr << "Unable to write the frame log: " << strerror(errno) << ", " << batch.size() << " records lost" << endl;
+
+            if (ftruncate(this -> fd, this -> length) != 0 || lseek(this -> fd, this -> length, SEEK_SET) < 0){
+                cerr << "Unable to repair the frame log: " << strerror(errno) << endl;
+            }
+        }
+
+        batch.clear();
+    }
+}
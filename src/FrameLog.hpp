@@ -0,0 +1,34 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <sys/types.h>
+
+#include "FrameRecord.hpp"
+
+class FrameLog
+{
+	private:
+    	int fd; //descriptor of the log file, -1 if the log is disabled
+    	off_t length; //bytes of the file made of the header and complete records
+
+    	std::vector<FrameRecord> pending; //records not yet written
+    	std::mutex lock;
+    	std::condition_variable wakeUp;
+    	bool stop;
+
+    	std::thread writer;
+
+	public:
+		FrameLog(std::string);
+		~FrameLog();
+		void append(const FrameRecord&);
+
+	private:
+		bool hasValidHeader();
+		bool writeAll(const void*, size_t);
+		void writeLoop();
+
+};
@@ -0,0 +1,91 @@
+#include "FrameLogReader.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+    Constructor of the class. The log is mapped in memory, so the records are read 
+    directly from the page cache without copying them. A record that is only partially 
+    written at the end of the file is ignored.
+
+    @param path = path of the log file.
+*/
+FrameLogReader::FrameLogReader(std::string path){
+
+    this -> data = NULL;
+    this -> length = 0;
+    this -> records = NULL;
+    this -> count = 0;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0){
+        cerr << "Unable to open the frame log " << path << endl;
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || (size_t)info.st_size < sizeof(FrameLogHeader)){
+        cerr << "Invalid frame log " << path << endl;
+        close(fd);
+        return;
+    }
+
+    void* mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); //the mapping stays valid
+    if (mapped == MAP_FAILED){
+        cerr << "Unable to map the frame log " << path << endl;
+        return;
+    }
+
+    const FrameLogHeader* header = (const FrameLogHeader*) mapped;
+    if (memcmp(header -> magic, FRAME_LOG_MAGIC, 8) != 0 || header -> version != FRAME_LOG_VERSION 
+        || header -> record_size != sizeof(FrameRecord)){
+        cerr << "Invalid frame log " << path << endl;
+        munmap(mapped, info.st_size);
+        return;
+    }
+
+    this -> data = mapped;
+    this -> length = info.st_size;
+    this -> records = (const FrameRecord*) ((const char*) mapped + sizeof(FrameLogHeader));
+    this -> count = (this -> length - sizeof(FrameLogHeader)) / sizeof(FrameRecord);
+
+    madvise(this -> data, this -> length, MADV_SEQUENTIAL); //records are usually scanned in order
+}
+
+/**
+    Destructor of the class.
+*/
+FrameLogReader::~FrameLogReader(){
+
+    if (this -> data != NULL){
+        munmap(this -> data, this -> length);
+    }
+}
+
+/**
+    @return bool = true if the log has been opened and its header is correct.
+*/
+bool FrameLogReader::isValid(){
+	return data != NULL;
+}
+
+/**
+    @return size_t = number of records in the log.
+*/
+size_t FrameLogReader::getCount(){
+	return count;
+}
+
+/**
+    @param i = index of the record.
+    @return FrameRecord = record of the i-th frame logged.
+*/
+const FrameRecord& FrameLogReader::getRecord(size_t i){
+	return records[i];
+}
@@ -0,0 +1,22 @@
+#include <iostream>
+#include <string>
+
+#include "FrameRecord.hpp"
+
+class FrameLogReader
+{
+	private:
+    	void* data;
+    	size_t length;
+
+    	const FrameRecord* records;
+    	size_t count;
+
+	public:
+		FrameLogReader(std::string);
+		~FrameLogReader();
+		bool isValid();
+		size_t getCount();
+		const FrameRecord& getRecord(size_t);
+
+};
@@ -0,0 +1,62 @@
+#ifndef FRAMERECORD_HPP
+#define FRAMERECORD_HPP
+
+#include <cstdint>
+
+/**
+    Layout of the binary frame log. The file starts with a header followed by one
+    fixed-size record per frame, in the byte order of the machine that wrote it.
+    The 8 bytes fields come first, all the others are 4 bytes long and their number is 
+    even, so the structs have no padding.
+*/
+
+static const char FRAME_LOG_MAGIC[8] = {'A','B','S','F','L','O','G','\0'};
+static const uint32_t FRAME_LOG_VERSION = 3;
+
+struct FrameLogHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t record_size;
+};
+
+struct FrameRecord
+{
+	uint64_t session; //start time of the run in microseconds since the epoch, same for all its frames
+	uint64_t timestamp; //capture time of the frame in microseconds since the epoch
+
+	uint32_t frame; //index of the frame in the run
+	uint32_t reused; //1 if the result of the previous frame has been reused
+
+	// Lane lines in the form y = mx + q
+	float m1;
+	float q1;
+	float m2;
+	float q2;
+
+	// Limits of the road detected
+	int32_t min_y;
+	int32_t max_y;
+
+	// Window of the obstacle as drawn, window_size is 0 if there is no obstacle.
+	// density is the number of edge pixels in this window divided by window_size^2.
+	int32_t window_x;
+	int32_t window_y;
+	int32_t window_size;
+	float density;
+
+	int32_t message; //level of alert
+
+	// Execution times in milliseconds: motion gate, lane lines and car detection stages
+	// (0 if the result has been reused) and the whole frame
+	float gate_ms;
+	float lane_ms;
+	float car_ms;
+	float total_ms;
+
+	uint32_t reserved; //always 0, keeps the size of the record a multiple of 8 bytes
+};
+
+static_assert(sizeof(FrameRecord) == 88, "FrameRecord must not contain padding");
+
+#endif
@@ -6,25 +6,23 @@ using namespace cv;
 /**
     Constructor of the class.
 
-    @param image =  image to be processed
+    @param context =  context of the frame to be processed
 */
-LaneLines::LaneLines(cv::Mat image){
+LaneLines::LaneLines(FrameContext& context) : context(context){
     
-    this -> image = image;
+    this -> image = context.getImage();
 }
 
 /**
-    Method that filters the image keeping only the white and yellow pixels. The result is saved
-    in the variable cv::laneImage. 
-*/
-void LaneLines::selectColor(){
-
-    //Image with same size of the original image that will contain only the interested colors
-    this -> laneImage = Mat(image.rows, image.cols, CV_8UC1, Scalar(0,0,0));
+    Method that filters a band of the image keeping only the white and yellow pixels.
 
+    @param input = band of the original image to be filtered.
+    @return Mat = mask of the band, non-zero only on the white and yellow pixels.
+*/
+cv::Mat LaneLines::selectColor(cv::Mat input){
 
 	Mat hls_image; 
-	cvtColor(image, hls_image, COLOR_BGR2HLS);
+	cvtColor(input, hls_image, COLOR_BGR2HLS);
 
 	Mat whiteMask;
 	inRange(hls_image, Scalar(0,190,0), Scalar(255,255,255), whiteMask);
@@ -34,27 +32,26 @@ void LaneLines::selectColor(){
 	Mat mask; 
 	bitwise_or(whiteMask, yellowMask, mask); //merge masks
 
-	bitwise_and(image, image, laneImage, mask=mask); //merge mask and original image
-
+	return mask;
 }
 
 /**
     Method that defines the region of interest of the image. All the pixels that do not
-    belong to the ROI are set to black. The region of interest is a triangle which verteces 
+    belong to the ROI are removed from the mask. The region of interest is a triangle which verteces 
     are proportional to image dimensions and they cover the area of the image in which 
     very likely there is the road.
+    The vertices are always computed on the whole image, so that a band gets exactly the
+    same ROI it would have in the untiled image.
     
-    @param input = image to which set the ROI.
-    @return Mat = input image converted to gray color-space with no-interesting pixels 
-                  set to black.
+    @param input = mask of the band to which set the ROI.
+    @param offset_y = row of the whole image where the band starts.
+    @return Mat = input mask with no-interesting pixels set to zero.
 */
-cv::Mat LaneLines::setRegionOfInterest(cv::Mat input){
-	
-	Mat out; //output image
+cv::Mat LaneLines::setRegionOfInterest(cv::Mat input, int offset_y){
 
 	Point b_left, b_right, center; //vertices of the triangle
 	
-    Size s = input.size();
+    Size s = this -> image.size();
 
 	b_left.x = cvRound(s.width*0.25);
 	b_left.y = cvRound(s.height*0.66);
@@ -74,35 +71,79 @@ cv::Mat LaneLines::setRegionOfInterest(cv::Mat input){
     float mRight = (b_right.y - center.y) / (float)(b_right.x - center.x);
     float qRight = b_right.y - mRight * b_right.x;
 
-    for (int y = 0; y < s.height; y++) {
-            for (int x = 0; x < s.width; x++) {
-                // Color pixel only if is below the two lines
+    for (int row = 0; row < input.rows; row++) {
+            int y = row + offset_y; //row in the whole image
+            uchar* pixels = input.ptr<uchar>(row);
+            for (int x = 0; x < input.cols; x++) {
+                // Keep pixel only if is below the two lines
                 if (!((y > mLeft * x + qLeft) && (y > mRight * x + qRight))) {
-                    input.at<Vec3b>(Point(x,y)) = black;
+                    pixels[x] = 0;
                     
                 }
             
             }
     }
 
+    return input;
+}
 
-    cvtColor(input, out, CV_BGR2GRAY);
+/**
+    Method that executes color selection, ROI and blur on the band [y_start, y_end) of the 
+    image. The band is extended by blur_halo rows on each side (clipped to the image), so 
+    that the blurred rows of the band are identical to the ones of the whole blurred image.
+    Only the rows of the band are written to the output.
+    The gray pixels are taken from the frame context: converting the masked band to gray 
+    gives the same values, since the removed pixels are black.
+
+    @param gray = gray frame.
+    @param blurred = gray image where the blurred band is saved.
+    @param y_start = first row of the band.
+    @param y_end = row after the last one of the band.
+*/
+void LaneLines::processBand(cv::Mat gray, cv::Mat blurred, int y_start, int y_end){
 
-    return out;
+    int top = max(0, y_start - blur_halo);
+    int bottom = min(this -> image.rows, y_end + blur_halo);
+
+    Mat mask = LaneLines::selectColor(this -> image.rowRange(top, bottom));
+
+    mask = LaneLines::setRegionOfInterest(mask, top);
+
+    Mat band = Mat::zeros(mask.size(), CV_8UC1);
+    gray.rowRange(top, bottom).copyTo(band, mask); //keep only the interesting gray pixels
+
+    GaussianBlur(band, band, Size(blur_size, blur_size), 0); //blurs the band
+
+    band.rowRange(y_start - top, y_end - top).copyTo(blurred.rowRange(y_start, y_end));
 }
 
 /**
-    Method that detects edges in the input image.
+    Method that detects edges in the image. The image is split in horizontal bands of 
+    band_height rows; each band is filtered, masked and blurred on a single core while it
+    is still in cache, and the bands are processed in parallel.
+    Canny is then executed on the whole blurred image, because its hysteresis can follow an
+    edge across any number of bands (OpenCV already parallelizes it internally).
 
-    @param input = gray image to be processed.
     @return Mat = gray image with the detected edges. 
 */
-cv::Mat LaneLines::edgeDetector(cv::Mat input){
+cv::Mat LaneLines::edgeDetector(){
 
-    GaussianBlur(input, input, Size(15,15), 0); //blurs the input image
+    Mat gray = this -> context.getGray(); //computed once, before the bands share it
+
+    Mat blurred(this -> image.size(), CV_8UC1);
+
+    int n_bands = (this -> image.rows + band_height - 1) / band_height;
+
+    parallel_for_(Range(0, n_bands), [&](const Range& range){
+        for (int i = range.start; i < range.end; i++){
+            int y_start = i * band_height;
+            int y_end = min(this -> image.rows, y_start + band_height);
+            LaneLines::processBand(gray, blurred, y_start, y_end);
+        }
+    });
 
     Mat detected_edges;
-    Canny(input, detected_edges, 60, 180); //Canny edge detector
+    Canny(blurred, detected_edges, 60, 180); //Canny edge detector
 
     return detected_edges;
 }
@@ -205,6 +246,19 @@ void LaneLines::defineLaneLines(std::vector<cv::Vec4i> input){
 	finalPoints.push_back(secondLine);
 
 	LaneLines::findLineParams(finalPoints); //save lines coefficients for future use
+
+    /*
+    We need to computed the top and down limits of the two lines in order to build a 
+    trapeze, that is the region to color.
+    */
+    int max_y_left =  max(finalPoints[0][1], finalPoints[0][3]);
+    int max_y_right = max(finalPoints[1][1], finalPoints[1][3]);
+    int min_y_left =  min(finalPoints[0][1], finalPoints[0][3]);
+    int min_y_right = min(finalPoints[1][1], finalPoints[1][3]);
+
+    //These values will be useful for improving the car detection procedure too.
+    this -> min_y = min(min_y_left, min_y_right);
+    this -> max_y = max(max_y_left, max_y_right);
 }
 
 
@@ -266,20 +320,6 @@ void LaneLines::color(){
 
 	Size s =  prov.size();
 
-    /*
-    We need to computed the top and down limits of the two lines in order to build a 
-    trapeze, that is the region to color.
-    */
-    int max_y_left =  max(finalPoints[0][1], finalPoints[0][3]);
-    int max_y_right = max(finalPoints[1][1], finalPoints[1][3]);
-    int min_y_left =  min(finalPoints[0][1], finalPoints[0][3]);
-    int min_y_right = min(finalPoints[1][1], finalPoints[1][3]);
-
-    //These values will be useful for improving the car detection procedure too.
-    this -> min_y = min(min_y_left, min_y_right);
-    this -> max_y = max(max_y_left, max_y_right);
-
-
     for (int y = 0; y < s.height; y++) {
             for (int x = 0; x < s.width; x++) {
                 // Color pixel only if is below the two lines and between min_y and max_y
@@ -291,34 +331,8 @@ void LaneLines::color(){
     }
 
     addWeighted(this -> image, 0.6, prov, 0.4, 0, this -> final); //blurs a bit the blue pixels
-}
 
-/**
-    Based on the portion of road detected, this method computes an image in which all the pixels
-    that do not belong to the portion of road in front of the car are set to black.
-    This method is useful because produces an image that optimizes the detection of the car.
-
-*/
-void LaneLines::createRegion(){
-    
-    float prov_m1 = this -> m1; 
-	float prov_m2 = this -> m2; 
-
-	image.copyTo(this -> regionImage);
-	Size s =  this -> regionImage.size();
-
-    for (int y = 0; y < s.height; y++) {
-            for (int x = 0; x < s.width; x++) {
-                /*
-                Color pixel only if is below the two lines. The lines are traslated of 100 px in order to properly set the ROI.
-                */
-                if (!((y > prov_m1 * x + q1 - 100) && (y > prov_m2 * x + q2 - 100) || y > max_y + 200 )) {
-                    this -> regionImage.at<Vec3b>(Point(x,y)) = black;
-                }
-            
-        }
-    }
-    
+    this -> context.setOverlay(this -> final); //the car detected is drawn on the same image
 }
 
 /**
@@ -327,13 +341,9 @@ void LaneLines::createRegion(){
 */
 void LaneLines::processRoad(){
 
-    LaneLines::selectColor();
-    
     Mat out;
 
-    out = LaneLines::setRegionOfInterest(this -> laneImage);
-
-    out = LaneLines::edgeDetector(out);
+    out = LaneLines::edgeDetector();
 
     HoughLinesP(out, this -> lines, 1, 1 * CV_PI/180, 90, 30, 50 );
 
@@ -341,22 +351,35 @@ void LaneLines::processRoad(){
 
     LaneLines::color();
 
-    LaneLines::createRegion();
+    this -> context.setRoad(m1, q1, m2, q2, max_y); //the ROI for car detection is built from the lines
 
 }
 
 /**
-    @return Mat = image with the detected portion of road.
+    Public method that colors on the image a portion of road found in a previous frame,
+    without searching the lane lines again.
+
+    @param params = slope coefficients and constants of the two lane lines (m1, q1, m2, q2).
+    @param min_y = upper limit of the road.
+    @param max_y = lower limit of the road.
 */
-Mat LaneLines::getRecognizedLines(){
-	return final;
+void LaneLines::drawRoad(cv::Vec4f params, int min_y, int max_y){
+
+    this -> m1 = params[0];
+    this -> q1 = params[1];
+    this -> m2 = params[2];
+    this -> q2 = params[3];
+    this -> min_y = min_y;
+    this -> max_y = max_y;
+
+    LaneLines::color();
 }
 
 /**
-    @return Mat = image with the ROI for car detection.
+    @return Mat = image with the detected portion of road.
 */
-Mat LaneLines::getRegionImage(){
-	return regionImage;
+Mat LaneLines::getRecognizedLines(){
+	return final;
 }
 
 /**
@@ -371,4 +394,11 @@ int LaneLines::getMinY(){
 */
 int LaneLines::getMaxY(){
 	return max_y;
+}
+
+/**
+    @return Vec4f = slope coefficients and constants of the two lane lines (m1, q1, m2, q2).
+*/
+Vec4f LaneLines::getLineParams(){
+	return Vec4f(m1, q1, m2, q2);
 }
\ No newline at end of file
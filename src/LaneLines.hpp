@@ -4,13 +4,15 @@
 #include <opencv2/imgproc.hpp>
 #include <opencv2/core.hpp>
 
+#include "FrameContext.hpp"
+
 class LaneLines
 {
 	private:
+    	FrameContext& context;
+
     	cv::Mat image;
-    	cv::Mat laneImage;
     	cv::Mat final;
-    	cv::Mat regionImage;
 
     	std::vector<cv::Vec4i> lines;
 
@@ -23,27 +25,31 @@ class LaneLines
     	int max_y;
     	int min_y;
 
-    	cv::Vec3b black = cv::Vec3b(0,0,0);
     	cv::Vec3b blue = cv::Vec3b(255,0,0);
 
+    	int const band_height = 128; //rows of each band processed by a single core
+    	int const blur_size = 15; //side of the Gaussian blur kernel
+    	int const blur_halo = blur_size / 2; //extra rows needed by the blur, fewer rows change the result
+
 
 	public:
-		LaneLines(cv::Mat);
+		LaneLines(FrameContext&);
 		void processRoad();
+		void drawRoad(cv::Vec4f, int, int);
 		cv::Mat getRecognizedLines();
-		cv::Mat getRegionImage();
 		int getMaxY();
 		int getMinY();
+		cv::Vec4f getLineParams();
 
 
 	private:
-		void selectColor();
-		cv::Mat setRegionOfInterest(cv::Mat);
-		cv::Mat edgeDetector(cv::Mat);
+		cv::Mat selectColor(cv::Mat);
+		cv::Mat setRegionOfInterest(cv::Mat, int);
+		void processBand(cv::Mat, cv::Mat, int, int);
+		cv::Mat edgeDetector();
 		void defineLaneLines(std::vector<cv::Vec4i>);
 		std::vector<float> selectSlopeCoefficients(std::vector<cv::Vec4i>);
 		void color();
-		void createRegion();
 		void findLineParams(std::vector<cv::Vec4i>);
 
 
@@ -0,0 +1,115 @@
+#include "MotionGate.hpp"
+
+using namespace std;
+using namespace cv;
+
+/**
+    Constructor of the class.
+*/
+MotionGate::MotionGate(){
+
+    this -> changed_blocks = 0;
+    this -> skipped = 0;
+    this -> recomputed = 0;
+}
+
+/**
+    Method that reduces the frame to a small gray image. The frame is resized before the
+    conversion to gray, so that only the small image is converted.
+
+    @param frame = image to be reduced.
+    @return Mat = downsampled gray image.
+*/
+cv::Mat MotionGate::downsample(cv::Mat frame){
+
+    Mat small;
+    resize(frame, small, Size(), 1.0 / scale, 1.0 / scale, INTER_AREA);
+
+    Mat gray;
+    cvtColor(small, gray, CV_BGR2GRAY);
+
+    return gray;
+}
+
+/**
+    Method that decides if the frame must be processed again. The downsampled frame is 
+    compared block by block with the last processed one (the reference): a block is changed
+    if the mean absolute difference of its pixels is above the threshold. Only the blocks
+    that can touch the road are relevant, i.e. the blocks below the top of the lane detection
+    ROI or below the top of the car detection ROI of the last processed frame, moved up by 
+    the rows that the blur and Canny neighbourhoods reach.
+    The reference is updated only when the frame is processed, so a slow drift is detected
+    as soon as it accumulates.
+
+    @param frame = image to be checked.
+    @param roi_top = first row of the car detection ROI in the last processed frame.
+    @return bool = true if the frame must be processed, false if the last result can be reused.
+*/
+bool MotionGate::hasChanged(cv::Mat frame, int roi_top){
+
+    Mat current = MotionGate::downsample(frame);
+
+    if (this -> reference.empty() || this -> reference.size() != current.size()){
+        this -> changed_blocks = -1; //Nothing to compare with.
+        this -> reference = current;
+        this -> recomputed++;
+        return true;
+    }
+
+    Mat diff;
+    absdiff(current, this -> reference, diff);
+
+    //Mean difference of each block
+    Mat blocks;
+    Size grid((diff.cols + block_size - 1) / block_size, (diff.rows + block_size - 1) / block_size);
+    resize(diff, blocks, grid, 0, 0, INTER_AREA);
+
+    //First relevant row of the whole image
+    int top = max(0, min(cvRound(frame.rows * 0.5), roi_top - filter_margin));
+
+    this -> changed_blocks = 0;
+
+    for (int row = 0; row < blocks.rows; row++) {
+            //Skip the block if its last row is above the relevant area
+            if ((row + 1) * block_size * scale <= top) {
+                continue;
+            }
+            uchar* values = blocks.ptr<uchar>(row);
+            for (int col = 0; col < blocks.cols; col++) {
+                if (values[col] > threshold) {
+                    this -> changed_blocks++;
+                }
+            }
+    }
+
+    if (this -> changed_blocks == 0){
+        this -> skipped++;
+        return false;
+    }
+
+    this -> reference = current;
+    this -> recomputed++;
+    return true;
+}
+
+/**
+    @return int = number of relevant blocks changed in the last checked frame, -1 if there 
+                  was no reference to compare with.
+*/
+int MotionGate::getChangedBlocks(){
+	return changed_blocks;
+}
+
+/**
+    @return int = number of frames for which the last result has been reused.
+*/
+int MotionGate::getSkipped(){
+	return skipped;
+}
+
+/**
+    @return int = number of frames that have been processed.
+*/
+int MotionGate::getRecomputed(){
+	return recomputed;
+}
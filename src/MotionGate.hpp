@@ -0,0 +1,31 @@
+#include <iostream>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/highgui.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/core.hpp>
+
+class MotionGate
+{
+	private:
+    	cv::Mat reference; //downsampled gray of the last frame that was fully processed
+
+    	int changed_blocks;
+    	int skipped;
+    	int recomputed;
+
+    	int const scale = 8; //downsampling factor of the frame
+    	int const block_size = 8; //side of a block in downsampled pixels
+    	float const threshold = 6; //mean absolute difference above which a block is changed
+    	int const filter_margin = 4; //rows above the ROI that reach it through blur and Canny
+
+	public:
+		MotionGate();
+		bool hasChanged(cv::Mat, int);
+		int getChangedBlocks();
+		int getSkipped();
+		int getRecomputed();
+
+	private:
+		cv::Mat downsample(cv::Mat);
+
+};
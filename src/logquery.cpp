@@ -0,0 +1,110 @@
+#include "FrameLogReader.hpp"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+/**
+    Returns the p-th percentile of the values. The vector is partially reordered.
+*/
+float percentile(vector<float>& values, float p){
+
+    size_t k = (size_t)(p * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + k, values.end());
+
+    return values[k];
+}
+
+/**
+    Reads a frame log and prints a summary: number of runs, number of frames for each level
+    of alert, number of reused results and percentiles of the execution times.
+    If a level is given, prints also the frames with that level of alert, identified by
+    the session of the run, the index in the run and the capture time.
+
+    Usage: ./logquery <log file> [level]
+*/
+int main(int argc, char** argv) {
+
+    if (argc < 2){
+        cerr << "Usage: " << argv[0] << " <log file> [level]" << endl;
+        return 1;
+    }
+
+    FrameLogReader log (argv[1]);
+    if (!log.isValid()){
+        return 1;
+    }
+
+    int level = -1;
+    if (argc > 2){
+        level = atoi(argv[2]);
+    }
+
+    size_t n_frames = log.getCount();
+
+    size_t levels[3] = {0, 0, 0};
+    size_t reused = 0;
+    size_t sessions = 0;
+
+    vector<float> total_times;
+    vector<float> gate_times;
+    vector<float> lane_times;
+    vector<float> car_times;
+    total_times.reserve(n_frames);
+    gate_times.reserve(n_frames);
+
+    for (size_t i = 0; i < n_frames; ++i){
+        
+        const FrameRecord& record = log.getRecord(i);
+
+        // The runs are appended one after the other
+        if (i == 0 || record.session != log.getRecord(i - 1).session){
+            sessions++;
+        }
+
+        if (record.message >= 0 && record.message < 3){
+            levels[record.message]++;
+        }
+
+        if (record.message == level){
+            cout << "Session " << record.session << " frame " << record.frame << " time " << record.timestamp
+                 << " window (" << record.window_x << ", " << record.window_y
+                 << ") size " << record.window_size << " density " << record.density << endl;
+        }
+
+        if (record.reused){
+            reused++;
+        }
+        else{
+            // Only the processed frames are useful for the times of the stages
+            lane_times.push_back(record.lane_ms);
+            car_times.push_back(record.car_ms);
+        }
+
+        // The motion gate runs on every frame
+        gate_times.push_back(record.gate_ms);
+        total_times.push_back(record.total_ms);
+    }
+
+    cout << "Runs " << sessions << ", frames " << n_frames << ", reused results " << reused << endl;
+    cout << "Free " << levels[0] << ", attention " << levels[1] << ", slow down " << levels[2] << endl;
+
+    if (n_frames == 0){
+        return 0;
+    }
+
+    cout << "Total duration p50 " << percentile(total_times, 0.5) << "ms, p90 " << percentile(total_times, 0.9)
+         << "ms, p99 " << percentile(total_times, 0.99) << "ms" << endl;
+
+    cout << "Motion gate p50 " << percentile(gate_times, 0.5) << "ms, p99 " << percentile(gate_times, 0.99) << "ms" << endl;
+
+    if (!lane_times.empty()){
+        cout << "Lane lines p50 " << percentile(lane_times, 0.5) << "ms, p99 " << percentile(lane_times, 0.99) << "ms" << endl;
+        cout << "Car detection p50 " << percentile(car_times, 0.5) << "ms, p99 " << percentile(car_times, 0.99) << "ms" << endl;
+    }
+
+	return 0;
+}
@@ -1,5 +1,8 @@
 #include "LaneLines.hpp"
 #include "CarDetection.hpp"
+#include "MotionGate.hpp"
+#include "FrameContext.hpp"
+#include "FrameLog.hpp"
 
 
 #include <iostream>
@@ -26,6 +29,21 @@ int main(int argc, char** argv) {
 
     auto total_time = 0; //Useful to calculate average execution time
 
+    MotionGate gate; //Detects if the scene changed since the last processed image
+
+    // Results of the last processed image, reused while the scene does not change
+    Vec4f params;
+    int min_y = 0;
+    int max_y = 0;
+    Rect window;
+    int message = 0;
+    int roi_top = 0; //first row of the ROI for car detection
+
+    FrameLog frameLog ("frames.log"); //Binary log with the result of each image
+    FrameRecord record = {};
+    record.session = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count(); //Identifies this run in the log
+
     for (int i = 1; i <= n_images; ++i){
         
         String path = general_path + to_string(i) + ".JPG";
@@ -34,6 +52,9 @@ int main(int argc, char** argv) {
         // Load image
         Mat img = imread(path);
 
+        record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
         cout << "Image " << i << endl;
         
         vconcat(img, processing, dst);
@@ -44,32 +65,87 @@ int main(int argc, char** argv) {
 
         std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
 
-        LaneLines obj (img);
+        bool changed = gate.hasChanged(img, roi_top);
 
-        obj.processRoad();
+        std::chrono::high_resolution_clock::time_point t_gate = std::chrono::high_resolution_clock::now();
+        record.gate_ms = std::chrono::duration<float, std::milli>(t_gate - t1).count();
 
-        Mat result = obj.getRegionImage();
-        Mat lines = obj.getRecognizedLines();
-        int min_y = obj.getMinY();
-        int max_y = obj.getMaxY();
-        
-        vconcat(lines, processing, dst);
-        namedWindow(window_name, WINDOW_NORMAL);
-        imshow(window_name, dst);
-        waitKey(1);
-        
-        CarDetection obj2 (lines, result, min_y, max_y);
-        obj2.detectCar();
+        FrameContext context (img); //Data shared by the two detectors
+
+        Mat final_result;
+
+        if (changed){
+
+            LaneLines obj (context);
+
+            obj.processRoad();
+
+            std::chrono::high_resolution_clock::time_point t_lane = std::chrono::high_resolution_clock::now();
+
+            Mat lines = obj.getRecognizedLines();
+            min_y = obj.getMinY();
+            max_y = obj.getMaxY();
+            params = obj.getLineParams();
+            
+            vconcat(lines, processing, dst);
+            namedWindow(window_name, WINDOW_NORMAL);
+            imshow(window_name, dst);
+            waitKey(1);
+            
+            std::chrono::high_resolution_clock::time_point t_car = std::chrono::high_resolution_clock::now();
+
+            CarDetection obj2 (context, min_y, max_y);
+            obj2.detectCar();
+
+            final_result = obj2.getDetectedCar();
+
+            message = obj2.getMessage();
+
+            roi_top = context.getRoadTop();
+
+            window = obj2.getWindow();
+
+            record.reused = 0;
+            record.m1 = params[0];
+            record.q1 = params[1];
+            record.m2 = params[2];
+            record.q2 = params[3];
+            record.min_y = min_y;
+            record.max_y = max_y;
+            record.window_x = window.x;
+            record.window_y = window.y;
+            record.window_size = window.width;
+            record.density = obj2.getDensity();
+            record.message = message;
+            record.lane_ms = std::chrono::duration<float, std::milli>(t_lane - t_gate).count();
+            record.car_ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - t_car).count();
+        }
+        else{
+            cout << "Scene unchanged, previous result reused" << endl;
+
+            // The road and the car of the last processed image are drawn on the current one
+            LaneLines obj (context);
+            obj.drawRoad(params, min_y, max_y);
+
+            CarDetection obj2 (context, min_y, max_y);
+            obj2.drawCar(window, message);
+
+            final_result = obj2.getDetectedCar();
+
+            // The record keeps the results of the last processed image
+            record.reused = 1;
+            record.lane_ms = 0;
+            record.car_ms = 0;
+        }
 
         std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
         cout << "Duration " << duration << "ms" << endl;
         total_time = total_time + duration;
 
-
-        Mat final_result = obj2.getDetectedCar();
-
-        int message = obj2.getMessage();
+        record.frame = i;
+        record.total_ms = std::chrono::duration<float, std::milli>(t2 - t1).count();
+        frameLog.append(record);
 
         if (message == 0){
             vconcat(final_result, free, dst);
@@ -90,6 +166,7 @@ int main(int argc, char** argv) {
 
     cout << " " << endl;
     cout << "Average duration " << total_time/n_images << "ms" << endl;
+    cout << "Processed images " << gate.getRecomputed() << ", reused results " << gate.getSkipped() << endl;
 
     waitKey(0);
 